@@ -13,27 +13,51 @@
 #define COMPONENT_MAX UINT16_MAX - 1
 #define ARCHETYPE_MAX UINT32_MAX - 1
 
+#ifndef ECSTATIC_INLINE_COMPONENT_MASK_BITS
+#define ECSTATIC_INLINE_COMPONENT_MASK_BITS 256
+#endif
+
+#if ECSTATIC_INLINE_COMPONENT_MASK_BITS < 128 || ECSTATIC_INLINE_COMPONENT_MASK_BITS % 128 != 0
+#error "ECSTATIC_INLINE_COMPONENT_MASK_BITS must be a non-zero multiple of 128"
+#endif
+
+#define ECSTATIC_INLINE_COMPONENT_MASK_COUNT (ECSTATIC_INLINE_COMPONENT_MASK_BITS / 64)
+
 #define ENTITY_INVALID UINT32_MAX
 #define COMPONENT_INVALID UINT16_MAX
 #define ARCHETYPE_INVALID UINT32_MAX
+#define SHARED_VALUE_INVALID UINT32_MAX
 
 typedef void (*ErrorCallback)(const char* caller, const char* fmt);
+typedef void (*EcstaticComponentCopyFunction)(void* destination, const void* source, uint32_t componentSize);
+typedef void (*EcstaticComponentZeroFunction)(void* destination, uint32_t componentSize);
 
 typedef uint32_t EcstaticEntityId;
 typedef uint16_t EcstaticComponentId;
 typedef uint32_t EcstaticArchetypeId;
+typedef uint32_t EcstaticSharedValueId;
 
 typedef struct EcstaticArchetype {
+    uint64_t inlineComponentMask[ECSTATIC_INLINE_COMPONENT_MASK_COUNT];
+
     void** components;
-    uint64_t* componentMask;
+    uint16_t* componentIds;
+    uint32_t* componentSizes;
+    EcstaticComponentCopyFunction* componentCopyFunctions;
+    EcstaticComponentZeroFunction* componentZeroFunctions;
+    uint64_t* heapComponentMask;
 
     uint32_t* archetypeEntityIdToEntityId;
 
+    uint32_t* sharedValueIds;
+
     uint32_t componentCount;
+    uint16_t sharedComponentCount;
 
     uint32_t entityCount;
     uint32_t entityCapacity;
 
+    // Trimmed word count; masks of up to ECSTATIC_INLINE_COMPONENT_MASK_COUNT words live zero-padded in inlineComponentMask
     uint16_t componentMaskCount;
 } EcstaticArchetype;
 
@@ -41,6 +65,17 @@ typedef struct EcstaticWorld {
     EcstaticArchetype* archetypes;
 
     uint32_t* componentSizes;
+    EcstaticComponentCopyFunction* componentCopyFunctions;
+    EcstaticComponentZeroFunction* componentZeroFunctions;
+    EcstaticComponentId* typedComponentIds;
+    bool* componentIsShared;
+
+    void** sharedValues;
+    uint16_t* sharedValueIdToComponentId;
+    uint32_t sharedValueCount;
+
+    uint32_t** sharedValueBucketSharedValueIds;
+    uint16_t* sharedValueBucketSharedValueCounts;
 
     uint32_t* entityIdToArchetypeId;
     uint32_t* entityIdToArchetypeEntityId;
@@ -66,26 +101,117 @@ EcstaticWorld* EcstaticCreateWorld(uint32_t initialEntityCapacity, uint32_t comp
 void EcstaticDestroyWorld(EcstaticWorld* world);
 
 EcstaticComponentId EcstaticCreateComponent(EcstaticWorld* world, uint64_t componentSize);
+EcstaticComponentId EcstaticCreateComponentWithFunctions(EcstaticWorld* world, uint64_t componentSize, EcstaticComponentCopyFunction copyFunction, EcstaticComponentZeroFunction zeroFunction);
+EcstaticComponentId EcstaticCreateTypedComponent(EcstaticWorld* world, uint16_t* typedComponentSlot, uint64_t componentSize, EcstaticComponentCopyFunction copyFunction, EcstaticComponentZeroFunction zeroFunction);
+EcstaticComponentId EcstaticGetTypedComponentId(const EcstaticWorld* world, uint16_t typedComponentSlot);
+EcstaticComponentId EcstaticCreateSharedComponent(EcstaticWorld* world, uint64_t componentSize);
+EcstaticSharedValueId EcstaticGetSharedValueId(EcstaticWorld* world, EcstaticComponentId componentId, const void* value);
 
 EcstaticEntityId EcstaticCreateEntity(EcstaticWorld* world);
 void EcstaticUpdateEntityComponents(EcstaticWorld* world, EcstaticEntityId entityId, uint64_t* componentMask, uint16_t componentMaskCount);
+void EcstaticUpdateEntitySharedComponents(EcstaticWorld* world, EcstaticEntityId entityId, const uint32_t* sharedValueIds, uint16_t sharedComponentCount);
+void EcstaticMoveEntityToArchetype(EcstaticWorld* world, EcstaticEntityId entityId, EcstaticArchetypeId newArchetypeId);
 void EcstaticAddComponentToEntity(EcstaticWorld* world, EcstaticEntityId entityId, EcstaticComponentId componentId);
 void EcstaticRemoveComponentFromEntity(EcstaticWorld* world, EcstaticEntityId entityId, EcstaticComponentId componentId);
 void* EcstaticGetEntityComponent(EcstaticWorld* world, EcstaticEntityId entityId, EcstaticComponentId componentId);
+void EcstaticSetEntitySharedComponent(EcstaticWorld* world, EcstaticEntityId entityId, EcstaticComponentId componentId, const void* value);
+void EcstaticRemoveSharedComponentFromEntity(EcstaticWorld* world, EcstaticEntityId entityId, EcstaticComponentId componentId);
+const void* EcstaticGetEntitySharedComponent(const EcstaticWorld* world, EcstaticEntityId entityId, EcstaticComponentId componentId);
 void EcstaticDestroyEntity(EcstaticWorld* world, EcstaticEntityId entityId);
 
-uint32_t EcstaticCreateArchetype(EcstaticWorld* world, uint64_t* componentMask, uint16_t componentMaskCount, uint32_t initialEntityCapacity);
-uint32_t EcstaticGetArchetypeIdHashFromComponentMask(const EcstaticWorld* world, const uint64_t* componentMask, uint16_t componentMaskCount);
-uint32_t EcstaticGetArchetypeIdFromComponentMask(const EcstaticWorld* world, const uint64_t* componentMask, uint16_t componentMaskCount);
+uint32_t EcstaticCreateArchetype(EcstaticWorld* world, uint64_t* componentMask, uint16_t componentMaskCount, const uint32_t* sharedValueIds, uint16_t sharedComponentCount, uint32_t initialEntityCapacity);
+uint32_t EcstaticGetArchetypeIdHashFromComponentMask(const EcstaticWorld* world, const uint64_t* componentMask, uint16_t componentMaskCount, const uint32_t* sharedValueIds, uint16_t sharedComponentCount);
+uint32_t EcstaticGetArchetypeIdFromComponentMask(const EcstaticWorld* world, const uint64_t* componentMask, uint16_t componentMaskCount, const uint32_t* sharedValueIds, uint16_t sharedComponentCount);
+const void* EcstaticGetArchetypeSharedComponent(const EcstaticWorld* world, EcstaticArchetypeId archetypeId, EcstaticComponentId componentId);
 uint32_t EcstaticGetArchetypeIdFromEntityId(const EcstaticWorld* world, EcstaticEntityId entityId);
 uint32_t EcstaticGetArchetypeEntityIdFromEntityId(const EcstaticWorld* world, EcstaticEntityId entityId);
 uint16_t EcstaticGetComponentIdFromArchetypeComponentId(uint64_t* componentMask, uint16_t componentMaskCount, uint16_t archetypeComponentId);
 uint16_t EcstaticGetArchetypeComponentIdFromComponentId(uint64_t* componentMask, uint16_t componentMaskCount, uint16_t componentId, bool silence);
 
+uint64_t* EcstaticGetArchetypeComponentMask(EcstaticArchetype* archetype);
+uint16_t EcstaticNormalizeComponentMask(const uint64_t* componentMask, uint16_t componentMaskCount, uint64_t* inlineComponentMask);
+bool EcstaticInlineComponentMaskEquals(const uint64_t* a, const uint64_t* b);
+
+void EcstaticCopyComponent(void* destination, const void* source, uint32_t componentSize);
+void EcstaticCopyComponent1(void* destination, const void* source, uint32_t componentSize);
+void EcstaticCopyComponent2(void* destination, const void* source, uint32_t componentSize);
+void EcstaticCopyComponent4(void* destination, const void* source, uint32_t componentSize);
+void EcstaticCopyComponent8(void* destination, const void* source, uint32_t componentSize);
+void EcstaticCopyComponent12(void* destination, const void* source, uint32_t componentSize);
+void EcstaticCopyComponent16(void* destination, const void* source, uint32_t componentSize);
+void EcstaticCopyComponent32(void* destination, const void* source, uint32_t componentSize);
+void EcstaticCopyComponent64(void* destination, const void* source, uint32_t componentSize);
+EcstaticComponentCopyFunction EcstaticGetComponentCopyFunction(uint64_t componentSize);
+
+void EcstaticZeroComponent(void* destination, uint32_t componentSize);
+void EcstaticZeroComponent1(void* destination, uint32_t componentSize);
+void EcstaticZeroComponent2(void* destination, uint32_t componentSize);
+void EcstaticZeroComponent4(void* destination, uint32_t componentSize);
+void EcstaticZeroComponent8(void* destination, uint32_t componentSize);
+void EcstaticZeroComponent12(void* destination, uint32_t componentSize);
+void EcstaticZeroComponent16(void* destination, uint32_t componentSize);
+void EcstaticZeroComponent32(void* destination, uint32_t componentSize);
+void EcstaticZeroComponent64(void* destination, uint32_t componentSize);
+EcstaticComponentZeroFunction EcstaticGetComponentZeroFunction(uint64_t componentSize);
+
 uint8_t EcstaticGetNthSetBitIndex(uint64_t x, int n);
 
 #ifdef __cplusplus
 }
 #endif
 
+#ifdef __cplusplus
+#define ECSTATIC_EXTERN extern "C"
+#else
+#define ECSTATIC_EXTERN extern
+#endif
+
+// Declares a typed component, e.g. ECSTATIC_COMPONENT(Position, struct { float x, y; });
+// ECSTATIC_COMPONENT_DEFINE(Position); must appear in exactly one source file
+// Each world holds its own id for the type, created with EcstaticCreate##name##Component
+#define ECSTATIC_COMPONENT(name, ...) \
+    typedef __VA_ARGS__ name; \
+    ECSTATIC_EXTERN uint16_t name##TypedComponentSlot; \
+    \
+    static inline void EcstaticCopy##name(void* destination, const void* source, uint32_t componentSize) { \
+        (void)componentSize; \
+        *(name*)destination = *(const name*)source; \
+    } \
+    \
+    static inline void EcstaticZero##name(void* destination, uint32_t componentSize) { \
+        (void)componentSize; \
+        memset(destination, 0, sizeof(name)); \
+    } \
+    \
+    static inline EcstaticComponentId EcstaticCreate##name##Component(EcstaticWorld* world) { \
+        return EcstaticCreateTypedComponent(world, &name##TypedComponentSlot, sizeof(name), EcstaticCopy##name, EcstaticZero##name); \
+    } \
+    \
+    static inline EcstaticComponentId EcstaticGet##name##ComponentId(const EcstaticWorld* world) { \
+        return EcstaticGetTypedComponentId(world, name##TypedComponentSlot); \
+    } \
+    \
+    static inline name* EcstaticGet##name(EcstaticWorld* world, EcstaticEntityId entityId) { \
+        return (name*)EcstaticGetEntityComponent(world, entityId, EcstaticGet##name##ComponentId(world)); \
+    } \
+    \
+    static inline void EcstaticIterate##name(EcstaticWorld* world, void (*function)(EcstaticArchetypeId archetypeId, name* components, uint32_t entityCount, void* userData), void* userData) { \
+        EcstaticComponentId componentId = EcstaticGet##name##ComponentId(world); \
+        if (componentId == COMPONENT_INVALID) return; \
+        \
+        for (uint32_t i = 0; i < world->archetypeCount; i++) { \
+            EcstaticArchetype* archetype = &world->archetypes[i]; \
+            if (archetype->entityCount == 0) continue; \
+            \
+            uint16_t archetypeComponentId = EcstaticGetArchetypeComponentIdFromComponentId(EcstaticGetArchetypeComponentMask(archetype), archetype->componentMaskCount, componentId, true); \
+            if (archetypeComponentId == COMPONENT_INVALID) continue; \
+            \
+            function(i, (name*)archetype->components[archetypeComponentId], archetype->entityCount, userData); \
+        } \
+    } \
+    \
+    ECSTATIC_EXTERN uint16_t name##TypedComponentSlot
+
+#define ECSTATIC_COMPONENT_DEFINE(name) uint16_t name##TypedComponentSlot = COMPONENT_INVALID
+
 #endif
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "../include/ecstatic.h"
 
 uint32_t lastEntityId = 0;
+uint16_t lastTypedComponentSlot = 0;
 ErrorCallback ecstaticErrorCallback = EcstaticDefaultErrorCallback;
 
 void EcstaticDefaultErrorCallback(const char* caller, const char* err) {
@@ -52,9 +53,51 @@ EcstaticWorld* EcstaticCreateWorld(uint32_t initialEntityCapacity, uint32_t comp
         return NULL;
     }
 
+    newWorld->componentCopyFunctions = calloc(1, COMPONENT_MAX * sizeof(EcstaticComponentCopyFunction));
+    if (!newWorld->componentCopyFunctions) {
+        EcstaticError(__func__, "Failed to allocate %zu bytes for EcstaticComponentCopyFunction* componentCopyFunctions", COMPONENT_MAX * sizeof(EcstaticComponentCopyFunction));
+        free(newWorld->componentSizes);
+        free(newWorld);
+        return NULL;
+    }
+
+    newWorld->componentZeroFunctions = calloc(1, COMPONENT_MAX * sizeof(EcstaticComponentZeroFunction));
+    if (!newWorld->componentZeroFunctions) {
+        EcstaticError(__func__, "Failed to allocate %zu bytes for EcstaticComponentZeroFunction* componentZeroFunctions", COMPONENT_MAX * sizeof(EcstaticComponentZeroFunction));
+        free(newWorld->componentCopyFunctions);
+        free(newWorld->componentSizes);
+        free(newWorld);
+        return NULL;
+    }
+
+    newWorld->typedComponentIds = malloc(COMPONENT_MAX * sizeof(EcstaticComponentId));
+    if (!newWorld->typedComponentIds) {
+        EcstaticError(__func__, "Failed to allocate %zu bytes for EcstaticComponentId* typedComponentIds", COMPONENT_MAX * sizeof(EcstaticComponentId));
+        free(newWorld->componentZeroFunctions);
+        free(newWorld->componentCopyFunctions);
+        free(newWorld->componentSizes);
+        free(newWorld);
+        return NULL;
+    }
+
+    newWorld->componentIsShared = calloc(1, COMPONENT_MAX * sizeof(bool));
+    if (!newWorld->componentIsShared) {
+        EcstaticError(__func__, "Failed to allocate %zu bytes for bool* componentIsShared", COMPONENT_MAX * sizeof(bool));
+        free(newWorld->typedComponentIds);
+        free(newWorld->componentZeroFunctions);
+        free(newWorld->componentCopyFunctions);
+        free(newWorld->componentSizes);
+        free(newWorld);
+        return NULL;
+    }
+
     newWorld->entityIdToArchetypeId = calloc(1, initialEntityCapacity * sizeof(uint32_t));
     if (!newWorld->entityIdToArchetypeId ) {
         EcstaticError(__func__, "Failed to allocate %zu bytes for uint32_t* entityIdToArchetypeId", initialEntityCapacity * sizeof(uint32_t));
+        free(newWorld->componentIsShared);
+        free(newWorld->typedComponentIds);
+        free(newWorld->componentZeroFunctions);
+        free(newWorld->componentCopyFunctions);
         free(newWorld->componentSizes);
         free(newWorld);
         return NULL;
@@ -64,6 +107,10 @@ EcstaticWorld* EcstaticCreateWorld(uint32_t initialEntityCapacity, uint32_t comp
     if (!newWorld->entityIdToArchetypeEntityId) {
         EcstaticError(__func__, "Failed to allocate %zu bytes for uint32_t* entityIdToArchetypeEntityId", initialEntityCapacity * sizeof(uint32_t));
         free(newWorld->entityIdToArchetypeId);
+        free(newWorld->componentIsShared);
+        free(newWorld->typedComponentIds);
+        free(newWorld->componentZeroFunctions);
+        free(newWorld->componentCopyFunctions);
         free(newWorld->componentSizes);
         free(newWorld);
         return NULL;
@@ -74,6 +121,10 @@ EcstaticWorld* EcstaticCreateWorld(uint32_t initialEntityCapacity, uint32_t comp
         EcstaticError(__func__, "Failed to allocate %zu bytes for uint32_t** componentMaskToArchetypeBucketArchetypeIds", componentMaskToArchetypeBucketCount * sizeof(uint32_t*));
         free(newWorld->entityIdToArchetypeEntityId);
         free(newWorld->entityIdToArchetypeId);
+        free(newWorld->componentIsShared);
+        free(newWorld->typedComponentIds);
+        free(newWorld->componentZeroFunctions);
+        free(newWorld->componentCopyFunctions);
         free(newWorld->componentSizes);
         free(newWorld);
         return NULL;
@@ -85,11 +136,52 @@ EcstaticWorld* EcstaticCreateWorld(uint32_t initialEntityCapacity, uint32_t comp
         free(newWorld->componentMaskToArchetypeBucketArchetypeIds);
         free(newWorld->entityIdToArchetypeEntityId);
         free(newWorld->entityIdToArchetypeId);
+        free(newWorld->componentIsShared);
+        free(newWorld->typedComponentIds);
+        free(newWorld->componentZeroFunctions);
+        free(newWorld->componentCopyFunctions);
         free(newWorld->componentSizes);
         free(newWorld);
         return NULL;
     }
 
+    newWorld->sharedValueBucketSharedValueIds = calloc(1, componentMaskToArchetypeBucketCount * sizeof(uint32_t*));
+    if (!newWorld->sharedValueBucketSharedValueIds) {
+        EcstaticError(__func__, "Failed to allocate %zu bytes for uint32_t** sharedValueBucketSharedValueIds", componentMaskToArchetypeBucketCount * sizeof(uint32_t*));
+        free(newWorld->componentMaskToArchetypeBucketArchetypeCounts);
+        free(newWorld->componentMaskToArchetypeBucketArchetypeIds);
+        free(newWorld->entityIdToArchetypeEntityId);
+        free(newWorld->entityIdToArchetypeId);
+        free(newWorld->componentIsShared);
+        free(newWorld->typedComponentIds);
+        free(newWorld->componentZeroFunctions);
+        free(newWorld->componentCopyFunctions);
+        free(newWorld->componentSizes);
+        free(newWorld);
+        return NULL;
+    }
+
+    newWorld->sharedValueBucketSharedValueCounts = calloc(1, componentMaskToArchetypeBucketCount * sizeof(uint16_t));
+    if (!newWorld->sharedValueBucketSharedValueCounts) {
+        EcstaticError(__func__, "Failed to allocate %zu bytes for uint16_t* sharedValueBucketSharedValueCounts", componentMaskToArchetypeBucketCount * sizeof(uint16_t));
+        free(newWorld->sharedValueBucketSharedValueIds);
+        free(newWorld->componentMaskToArchetypeBucketArchetypeCounts);
+        free(newWorld->componentMaskToArchetypeBucketArchetypeIds);
+        free(newWorld->entityIdToArchetypeEntityId);
+        free(newWorld->entityIdToArchetypeId);
+        free(newWorld->componentIsShared);
+        free(newWorld->typedComponentIds);
+        free(newWorld->componentZeroFunctions);
+        free(newWorld->componentCopyFunctions);
+        free(newWorld->componentSizes);
+        free(newWorld);
+        return NULL;
+    }
+
+    newWorld->sharedValues = NULL;
+    newWorld->sharedValueIdToComponentId = NULL;
+    newWorld->sharedValueCount = 0;
+
     newWorld->componentMaskToArchetypeBucketCount = componentMaskToArchetypeBucketCount;
     newWorld->entityCapacity = initialEntityCapacity;
     newWorld->archetypeCount = 0;
@@ -97,6 +189,7 @@ EcstaticWorld* EcstaticCreateWorld(uint32_t initialEntityCapacity, uint32_t comp
 
     memset(newWorld->entityIdToArchetypeId, 0xFF, initialEntityCapacity * 4);
     memset(newWorld->entityIdToArchetypeEntityId, 0XFF, initialEntityCapacity * 4);
+    memset(newWorld->typedComponentIds, 0xFF, COMPONENT_MAX * sizeof(EcstaticComponentId));
 
     return newWorld;
 }
@@ -110,19 +203,45 @@ void EcstaticDestroyWorld(EcstaticWorld *world) {
     if (world->archetypes) {
         for (uint32_t i = 0; i < world->archetypeCount; i++) {
             free(world->archetypes[i].archetypeEntityIdToEntityId);
-            if (world->archetypes[i].componentMask) free(world->archetypes[i].componentMask);
+            free(world->archetypes[i].sharedValueIds);
+            if (world->archetypes[i].heapComponentMask) free(world->archetypes[i].heapComponentMask);
 
             for (uint32_t j = 0; j < world->archetypes[i].componentCount; j++) {
                 free(world->archetypes[i].components[j]);
             }
 
             free(world->archetypes[i].components);
+            free(world->archetypes[i].componentIds);
+            free(world->archetypes[i].componentSizes);
+            free(world->archetypes[i].componentCopyFunctions);
+            free(world->archetypes[i].componentZeroFunctions);
         }
 
         free(world->archetypes);
     }
 
+    for (uint32_t i = 0; i < world->sharedValueCount; i++) {
+        free(world->sharedValues[i]);
+    }
+
+    free(world->sharedValues);
+    free(world->sharedValueIdToComponentId);
+
+    if (world->sharedValueBucketSharedValueIds) {
+        for (uint32_t i = 0; i < world->componentMaskToArchetypeBucketCount; i++) {
+            free(world->sharedValueBucketSharedValueIds[i]);
+        }
+
+        free(world->sharedValueBucketSharedValueIds);
+    }
+
+    free(world->sharedValueBucketSharedValueCounts);
+
     free(world->componentSizes);
+    free(world->componentCopyFunctions);
+    free(world->componentZeroFunctions);
+    free(world->typedComponentIds);
+    free(world->componentIsShared);
     free(world->entityIdToArchetypeId);
     free(world->entityIdToArchetypeEntityId);
 
@@ -140,17 +259,261 @@ void EcstaticDestroyWorld(EcstaticWorld *world) {
 }
 
 EcstaticComponentId EcstaticCreateComponent(EcstaticWorld* world, uint64_t componentSize) {
+    return EcstaticCreateComponentWithFunctions(world, componentSize, EcstaticGetComponentCopyFunction(componentSize), EcstaticGetComponentZeroFunction(componentSize));
+}
+
+EcstaticComponentId EcstaticCreateComponentWithFunctions(EcstaticWorld* world, uint64_t componentSize, EcstaticComponentCopyFunction copyFunction, EcstaticComponentZeroFunction zeroFunction) {
     if (componentSize < 1) {
         EcstaticError(__func__, "Failed to create component: componentSize cannot be less than one");
         return COMPONENT_INVALID;
     }
 
+    if (world->componentCount >= COMPONENT_MAX) {
+        EcstaticError(__func__, "Out of component indexes");
+        return COMPONENT_INVALID;
+    }
+
     world->componentSizes[world->componentCount] = componentSize;
+    world->componentCopyFunctions[world->componentCount] = copyFunction ? copyFunction : EcstaticCopyComponent;
+    world->componentZeroFunctions[world->componentCount] = zeroFunction ? zeroFunction : EcstaticZeroComponent;
     world->componentCount++;
 
     return world->componentCount - 1;
 }
 
+void EcstaticCopyComponent(void* destination, const void* source, uint32_t componentSize) {
+    memcpy(destination, source, componentSize);
+}
+
+void EcstaticCopyComponent1(void* destination, const void* source, uint32_t componentSize) {
+    (void)componentSize;
+    memcpy(destination, source, 1);
+}
+
+void EcstaticCopyComponent2(void* destination, const void* source, uint32_t componentSize) {
+    (void)componentSize;
+    memcpy(destination, source, 2);
+}
+
+void EcstaticCopyComponent4(void* destination, const void* source, uint32_t componentSize) {
+    (void)componentSize;
+    memcpy(destination, source, 4);
+}
+
+void EcstaticCopyComponent8(void* destination, const void* source, uint32_t componentSize) {
+    (void)componentSize;
+    memcpy(destination, source, 8);
+}
+
+void EcstaticCopyComponent12(void* destination, const void* source, uint32_t componentSize) {
+    (void)componentSize;
+    memcpy(destination, source, 12);
+}
+
+void EcstaticCopyComponent16(void* destination, const void* source, uint32_t componentSize) {
+    (void)componentSize;
+    _mm_storeu_si128((__m128i*)destination, _mm_loadu_si128((const __m128i*)source));
+}
+
+void EcstaticCopyComponent32(void* destination, const void* source, uint32_t componentSize) {
+    (void)componentSize;
+#if defined(__AVX__)
+    _mm256_storeu_si256((__m256i*)destination, _mm256_loadu_si256((const __m256i*)source));
+#else
+    _mm_storeu_si128((__m128i*)destination, _mm_loadu_si128((const __m128i*)source));
+    _mm_storeu_si128((__m128i*)destination + 1, _mm_loadu_si128((const __m128i*)source + 1));
+#endif
+}
+
+void EcstaticCopyComponent64(void* destination, const void* source, uint32_t componentSize) {
+    (void)componentSize;
+    EcstaticCopyComponent32(destination, source, 32);
+    EcstaticCopyComponent32((uint8_t*)destination + 32, (const uint8_t*)source + 32, 32);
+}
+
+EcstaticComponentCopyFunction EcstaticGetComponentCopyFunction(uint64_t componentSize) {
+    switch (componentSize) {
+        case 1: return EcstaticCopyComponent1;
+        case 2: return EcstaticCopyComponent2;
+        case 4: return EcstaticCopyComponent4;
+        case 8: return EcstaticCopyComponent8;
+        case 12: return EcstaticCopyComponent12;
+        case 16: return EcstaticCopyComponent16;
+        case 32: return EcstaticCopyComponent32;
+        case 64: return EcstaticCopyComponent64;
+        default: return EcstaticCopyComponent;
+    }
+}
+
+EcstaticComponentId EcstaticCreateTypedComponent(EcstaticWorld* world, uint16_t* typedComponentSlot, uint64_t componentSize, EcstaticComponentCopyFunction copyFunction, EcstaticComponentZeroFunction zeroFunction) {
+    if (*typedComponentSlot == COMPONENT_INVALID) {
+        if (lastTypedComponentSlot >= COMPONENT_MAX) {
+            EcstaticError(__func__, "Out of typed component slots");
+            return COMPONENT_INVALID;
+        }
+
+        *typedComponentSlot = lastTypedComponentSlot++;
+    }
+
+    if (world->typedComponentIds[*typedComponentSlot] != COMPONENT_INVALID) {
+        EcstaticError(__func__, "Typed component already created in this world: %hu", world->typedComponentIds[*typedComponentSlot]);
+        return world->typedComponentIds[*typedComponentSlot];
+    }
+
+    EcstaticComponentId componentId = EcstaticCreateComponentWithFunctions(world, componentSize, copyFunction, zeroFunction);
+    world->typedComponentIds[*typedComponentSlot] = componentId;
+
+    return componentId;
+}
+
+EcstaticComponentId EcstaticGetTypedComponentId(const EcstaticWorld* world, uint16_t typedComponentSlot) {
+    return typedComponentSlot == COMPONENT_INVALID ? COMPONENT_INVALID : world->typedComponentIds[typedComponentSlot];
+}
+
+void EcstaticZeroComponent(void* destination, uint32_t componentSize) {
+    memset(destination, 0, componentSize);
+}
+
+void EcstaticZeroComponent1(void* destination, uint32_t componentSize) {
+    (void)componentSize;
+    memset(destination, 0, 1);
+}
+
+void EcstaticZeroComponent2(void* destination, uint32_t componentSize) {
+    (void)componentSize;
+    memset(destination, 0, 2);
+}
+
+void EcstaticZeroComponent4(void* destination, uint32_t componentSize) {
+    (void)componentSize;
+    memset(destination, 0, 4);
+}
+
+void EcstaticZeroComponent8(void* destination, uint32_t componentSize) {
+    (void)componentSize;
+    memset(destination, 0, 8);
+}
+
+void EcstaticZeroComponent12(void* destination, uint32_t componentSize) {
+    (void)componentSize;
+    memset(destination, 0, 12);
+}
+
+void EcstaticZeroComponent16(void* destination, uint32_t componentSize) {
+    (void)componentSize;
+    _mm_storeu_si128((__m128i*)destination, _mm_setzero_si128());
+}
+
+void EcstaticZeroComponent32(void* destination, uint32_t componentSize) {
+    (void)componentSize;
+#if defined(__AVX__)
+    _mm256_storeu_si256((__m256i*)destination, _mm256_setzero_si256());
+#else
+    _mm_storeu_si128((__m128i*)destination, _mm_setzero_si128());
+    _mm_storeu_si128((__m128i*)destination + 1, _mm_setzero_si128());
+#endif
+}
+
+void EcstaticZeroComponent64(void* destination, uint32_t componentSize) {
+    (void)componentSize;
+    EcstaticZeroComponent32(destination, 32);
+    EcstaticZeroComponent32((uint8_t*)destination + 32, 32);
+}
+
+EcstaticComponentZeroFunction EcstaticGetComponentZeroFunction(uint64_t componentSize) {
+    switch (componentSize) {
+        case 1: return EcstaticZeroComponent1;
+        case 2: return EcstaticZeroComponent2;
+        case 4: return EcstaticZeroComponent4;
+        case 8: return EcstaticZeroComponent8;
+        case 12: return EcstaticZeroComponent12;
+        case 16: return EcstaticZeroComponent16;
+        case 32: return EcstaticZeroComponent32;
+        case 64: return EcstaticZeroComponent64;
+        default: return EcstaticZeroComponent;
+    }
+}
+
+EcstaticComponentId EcstaticCreateSharedComponent(EcstaticWorld* world, uint64_t componentSize) {
+    EcstaticComponentId componentId = EcstaticCreateComponent(world, componentSize);
+    if (componentId == COMPONENT_INVALID) return COMPONENT_INVALID;
+
+    world->componentIsShared[componentId] = true;
+
+    return componentId;
+}
+
+EcstaticSharedValueId EcstaticGetSharedValueId(EcstaticWorld* world, EcstaticComponentId componentId, const void* value) {
+    if (componentId >= world->componentCount || !world->componentIsShared[componentId]) {
+        EcstaticError(__func__, "Invalid shared component: %hu", componentId);
+        return SHARED_VALUE_INVALID;
+    }
+
+    uint32_t componentSize = world->componentSizes[componentId];
+    uint32_t hash = rapidhash_withSeed(value, componentSize, componentId) % world->componentMaskToArchetypeBucketCount;
+
+    uint32_t* hashBucketIds = world->sharedValueBucketSharedValueIds[hash];
+    uint16_t hashBucketCounts = world->sharedValueBucketSharedValueCounts[hash];
+
+    for (uint16_t i = 0; i < hashBucketCounts; i++) {
+        uint32_t sharedValueId = hashBucketIds[i];
+
+        if (world->sharedValueIdToComponentId[sharedValueId] == componentId && memcmp(world->sharedValues[sharedValueId], value, componentSize) == 0) {
+            return sharedValueId;
+        }
+    }
+
+    if (hashBucketCounts >= UINT16_MAX) {
+        EcstaticError(__func__, "Shared value bucket %u is full", hash);
+        return SHARED_VALUE_INVALID;
+    }
+
+    if (world->sharedValueCount >= SHARED_VALUE_INVALID) {
+        EcstaticError(__func__, "Out of shared value indexes");
+        return SHARED_VALUE_INVALID;
+    }
+
+    void* newValue = malloc(componentSize);
+    if (!newValue) {
+        EcstaticError(__func__, "Failed to allocate %zu bytes for void* newValue", (size_t)componentSize);
+        return SHARED_VALUE_INVALID;
+    }
+    memcpy(newValue, value, componentSize);
+
+    void* tmp = realloc(world->sharedValues, (world->sharedValueCount + 1) * sizeof(void*));
+    if (!tmp) {
+        EcstaticError(__func__, "Failed to reallocate %zu bytes for void** sharedValues", (world->sharedValueCount + 1) * sizeof(void*));
+        free(newValue);
+        return SHARED_VALUE_INVALID;
+    }
+    world->sharedValues = tmp;
+
+    void* tmp2 = realloc(world->sharedValueIdToComponentId, (world->sharedValueCount + 1) * sizeof(uint16_t));
+    if (!tmp2) {
+        EcstaticError(__func__, "Failed to reallocate %zu bytes for uint16_t* sharedValueIdToComponentId", (world->sharedValueCount + 1) * sizeof(uint16_t));
+        free(newValue);
+        return SHARED_VALUE_INVALID;
+    }
+    world->sharedValueIdToComponentId = tmp2;
+
+    void* tmp3 = realloc(hashBucketIds, (hashBucketCounts + 1) * sizeof(uint32_t));
+    if (!tmp3) {
+        EcstaticError(__func__, "Failed to reallocate %zu bytes for uint32_t* sharedValueBucketSharedValueIds[hash]", (hashBucketCounts + 1) * sizeof(uint32_t));
+        free(newValue);
+        return SHARED_VALUE_INVALID;
+    }
+    world->sharedValueBucketSharedValueIds[hash] = tmp3;
+
+    world->sharedValueBucketSharedValueIds[hash][hashBucketCounts] = world->sharedValueCount;
+    world->sharedValueBucketSharedValueCounts[hash]++;
+
+    world->sharedValues[world->sharedValueCount] = newValue;
+    world->sharedValueIdToComponentId[world->sharedValueCount] = componentId;
+    world->sharedValueCount++;
+
+    return world->sharedValueCount - 1;
+}
+
 EcstaticEntityId EcstaticGetNextEntityId() {
     if (lastEntityId >= ENTITY_MAX) return ENTITY_INVALID;
 
@@ -165,10 +528,10 @@ EcstaticEntityId EcstaticCreateEntity(EcstaticWorld* world) {
         return ENTITY_INVALID;
     }
 
-    uint32_t archetypeId = EcstaticGetArchetypeIdFromComponentMask(world, NULL, 0);
+    uint32_t archetypeId = EcstaticGetArchetypeIdFromComponentMask(world, NULL, 0, NULL, 0);
     
     if (archetypeId == ARCHETYPE_INVALID) {
-        archetypeId = EcstaticCreateArchetype(world, 0, 1, 1);
+        archetypeId = EcstaticCreateArchetype(world, NULL, 0, NULL, 0, 1);
     }
     
     EcstaticArchetype* archetype = &world->archetypes[archetypeId];
@@ -186,9 +549,7 @@ EcstaticEntityId EcstaticCreateEntity(EcstaticWorld* world) {
         archetype->archetypeEntityIdToEntityId = tmp;
 
         for (uint16_t i = 0; i < archetype->componentCount; i++) {
-            EcstaticComponentId globalComponentId = EcstaticGetComponentIdFromArchetypeComponentId(archetype->componentMask, archetype->componentMaskCount, i);
-
-            uint32_t componentSize = world->componentSizes[globalComponentId];
+            uint32_t componentSize = archetype->componentSizes[i];
 
             void* tmp = realloc(archetype->components[i], archetype->entityCapacity * componentSize);
             if (!tmp) {
@@ -229,12 +590,86 @@ EcstaticEntityId EcstaticCreateEntity(EcstaticWorld* world) {
 }
 
 void EcstaticUpdateEntityComponents(EcstaticWorld* world, EcstaticEntityId entityId, uint64_t* componentMask, uint16_t componentMaskCount) {
-    uint32_t newArchetypeId = EcstaticGetArchetypeIdFromComponentMask(world, componentMask, componentMaskCount);
+    uint32_t oldArchetypeId = EcstaticGetArchetypeIdFromEntityId(world, entityId);
+    if (oldArchetypeId == ARCHETYPE_INVALID) {
+        EcstaticError(__func__, "Invalid entity: %u ", entityId);
+        return;
+    }
+
+    for (uint16_t i = 0; i < componentMaskCount; i++) {
+        uint64_t componentMaskBits = componentMask[i];
+
+        while (componentMaskBits) {
+            uint32_t componentId = i * 64 + __builtin_ctzll(componentMaskBits);
+
+            if (componentId >= world->componentCount || world->componentIsShared[componentId]) {
+                EcstaticError(__func__, "Invalid component: %u ", componentId);
+                return;
+            }
+
+            componentMaskBits &= componentMaskBits - 1;
+        }
+    }
+
+    const uint32_t* sharedValueIds = world->archetypes[oldArchetypeId].sharedValueIds;
+    uint16_t sharedComponentCount = world->archetypes[oldArchetypeId].sharedComponentCount;
+
+    uint32_t newArchetypeId = EcstaticGetArchetypeIdFromComponentMask(world, componentMask, componentMaskCount, sharedValueIds, sharedComponentCount);
+
+    if (newArchetypeId == ARCHETYPE_INVALID) {
+        newArchetypeId = EcstaticCreateArchetype(world, componentMask, componentMaskCount, sharedValueIds, sharedComponentCount, 1);
+        if (newArchetypeId == ARCHETYPE_INVALID) return;
+    }
+
+    EcstaticMoveEntityToArchetype(world, entityId, newArchetypeId);
+}
+
+void EcstaticUpdateEntitySharedComponents(EcstaticWorld* world, EcstaticEntityId entityId, const uint32_t* sharedValueIds, uint16_t sharedComponentCount) {
+    uint32_t oldArchetypeId = EcstaticGetArchetypeIdFromEntityId(world, entityId);
+    if (oldArchetypeId == ARCHETYPE_INVALID) {
+        EcstaticError(__func__, "Invalid entity: %u ", entityId);
+        return;
+    }
+
+    for (uint16_t i = 0; i < sharedComponentCount; i++) {
+        if (sharedValueIds[i] >= world->sharedValueCount) {
+            EcstaticError(__func__, "Invalid shared value: %u ", sharedValueIds[i]);
+            return;
+        }
+
+        if (i > 0 && world->sharedValueIdToComponentId[sharedValueIds[i]] <= world->sharedValueIdToComponentId[sharedValueIds[i - 1]]) {
+            EcstaticError(__func__, "Shared values must have distinct components in ascending component order");
+            return;
+        }
+    }
+
+    uint64_t* componentMask = EcstaticGetArchetypeComponentMask(&world->archetypes[oldArchetypeId]);
+    uint16_t componentMaskCount = world->archetypes[oldArchetypeId].componentMaskCount;
+
+    uint32_t newArchetypeId = EcstaticGetArchetypeIdFromComponentMask(world, componentMask, componentMaskCount, sharedValueIds, sharedComponentCount);
 
     if (newArchetypeId == ARCHETYPE_INVALID) {
-        newArchetypeId = EcstaticCreateArchetype(world, componentMask, componentMaskCount, 1);
+        newArchetypeId = EcstaticCreateArchetype(world, componentMask, componentMaskCount, sharedValueIds, sharedComponentCount, 1);
+        if (newArchetypeId == ARCHETYPE_INVALID) return;
     }
 
+    EcstaticMoveEntityToArchetype(world, entityId, newArchetypeId);
+}
+
+void EcstaticMoveEntityToArchetype(EcstaticWorld* world, EcstaticEntityId entityId, EcstaticArchetypeId newArchetypeId) {
+    uint32_t oldArchetypeId = EcstaticGetArchetypeIdFromEntityId(world, entityId);
+    if (oldArchetypeId == ARCHETYPE_INVALID) {
+        EcstaticError(__func__, "Invalid entity: %u ", entityId);
+        return;
+    }
+
+    if (newArchetypeId >= world->archetypeCount) {
+        EcstaticError(__func__, "Invalid archetype: %u ", newArchetypeId);
+        return;
+    }
+
+    if (oldArchetypeId == newArchetypeId) return;
+
     EcstaticArchetype* newArchetype = &world->archetypes[newArchetypeId];
     uint32_t newArchetypeEntityId = newArchetype->entityCount;
 
@@ -251,9 +686,7 @@ void EcstaticUpdateEntityComponents(EcstaticWorld* world, EcstaticEntityId entit
         newArchetype->archetypeEntityIdToEntityId = tmp;
 
         for (uint16_t i = 0; i < newArchetype->componentCount; i++) {
-            uint16_t globalComponentId = EcstaticGetComponentIdFromArchetypeComponentId(newArchetype->componentMask, newArchetype->componentMaskCount, i);
-
-            uint32_t componentSize = world->componentSizes[globalComponentId];
+            uint32_t componentSize = newArchetype->componentSizes[i];
 
             void* tmp = realloc(newArchetype->components[i], newArchetype->entityCapacity * componentSize);
             if (!tmp) {
@@ -264,21 +697,24 @@ void EcstaticUpdateEntityComponents(EcstaticWorld* world, EcstaticEntityId entit
         }
     }
 
-    uint32_t oldArchetypeId = EcstaticGetArchetypeIdFromEntityId(world, entityId);
     uint32_t oldArchetypeEntityId = EcstaticGetArchetypeEntityIdFromEntityId(world, entityId);
     EcstaticArchetype* oldArchetype = &world->archetypes[oldArchetypeId];
 
-    for (uint32_t i = 0; i < oldArchetype->componentCount; i++) {
-        EcstaticComponentId componentId = EcstaticGetComponentIdFromArchetypeComponentId(oldArchetype->componentMask, oldArchetype->componentMaskCount, i);
-        uint16_t archetypeComponentId = EcstaticGetArchetypeComponentIdFromComponentId(newArchetype->componentMask, newArchetype->componentMaskCount, componentId, true);
+    uint32_t oldArchetypeComponentId = 0;
 
-        if (componentId != COMPONENT_INVALID && archetypeComponentId != COMPONENT_INVALID) {
-            uint32_t componentSize = world->componentSizes[componentId];
+    for (uint32_t i = 0; i < newArchetype->componentCount; i++) {
+        EcstaticComponentId componentId = newArchetype->componentIds[i];
+        uint32_t componentSize = newArchetype->componentSizes[i];
+        uint8_t* destinationComponent = (uint8_t*)newArchetype->components[i] + (size_t)newArchetypeEntityId * componentSize;
 
-            uint8_t* destinationComponent = (uint8_t*)newArchetype->components[archetypeComponentId];
-            uint8_t* sourceComponent = (uint8_t*)oldArchetype->components[i];
+        while (oldArchetypeComponentId < oldArchetype->componentCount && oldArchetype->componentIds[oldArchetypeComponentId] < componentId) oldArchetypeComponentId++;
 
-            memmove(destinationComponent + (newArchetypeEntityId * componentSize), sourceComponent + (oldArchetypeEntityId * componentSize), componentSize);
+        if (oldArchetypeComponentId < oldArchetype->componentCount && oldArchetype->componentIds[oldArchetypeComponentId] == componentId) {
+            uint8_t* sourceComponent = (uint8_t*)oldArchetype->components[oldArchetypeComponentId] + (size_t)oldArchetypeEntityId * componentSize;
+
+            newArchetype->componentCopyFunctions[i](destinationComponent, sourceComponent, componentSize);
+        } else {
+            newArchetype->componentZeroFunctions[i](destinationComponent, componentSize);
         }
     }
 
@@ -296,18 +732,11 @@ void EcstaticUpdateEntityComponents(EcstaticWorld* world, EcstaticEntityId entit
         world->entityIdToArchetypeEntityId[movedEntity] = oldArchetypeEntityId;
 
         for (uint32_t i = 0; i < oldArchetype->componentCount; i++) {
-            uint16_t componentId = EcstaticGetComponentIdFromArchetypeComponentId(oldArchetype->componentMask, oldArchetype->componentMaskCount, i);
-            uint32_t componentSize = world->componentSizes[componentId];
-            memcpy(oldArchetype->components[i] + oldArchetypeEntityId * componentSize, oldArchetype->components[i] + lastOldArchetypeEntityId * componentSize, componentSize);
-        }
-    }
-
-    for (uint32_t i = 0; i < newArchetype->componentCount; i++) {
-        uint16_t componentId = EcstaticGetComponentIdFromArchetypeComponentId(newArchetype->componentMask, newArchetype->componentMaskCount, i);
+            uint32_t componentSize = oldArchetype->componentSizes[i];
+            uint8_t* component = oldArchetype->components[i];
 
-        if (EcstaticGetArchetypeComponentIdFromComponentId(oldArchetype->componentMask, oldArchetype->componentMaskCount, componentId, true) != COMPONENT_INVALID) continue;
-
-        memset((uint8_t*)newArchetype->components[i] + (size_t)newArchetypeEntityId * world->componentSizes[componentId], 0, world->componentSizes[componentId]);
+            oldArchetype->componentCopyFunctions[i](component + oldArchetypeEntityId * componentSize, component + lastOldArchetypeEntityId * componentSize, componentSize);
+        }
     }
 
     oldArchetype->entityCount--;
@@ -322,12 +751,17 @@ void EcstaticAddComponentToEntity(EcstaticWorld* world, EcstaticEntityId entityI
         return;
     }
 
+    if (world->componentIsShared[componentId]) {
+        EcstaticError(__func__, "Component %hu is shared", componentId);
+        return;
+    }
+
     uint32_t oldArchetypeId = EcstaticGetArchetypeIdFromEntityId(world, entityId);
     EcstaticArchetype* oldArchetype = &world->archetypes[oldArchetypeId];
     uint16_t componentMaskIndex = componentId / 64;
 
     if (componentMaskIndex < oldArchetype->componentMaskCount) {
-        if (oldArchetype->componentMask[componentMaskIndex] & (1ULL << (componentId % 64))) {
+        if (EcstaticGetArchetypeComponentMask(oldArchetype)[componentMaskIndex] & (1ULL << (componentId % 64))) {
             EcstaticError(__func__, "Entity %u  already has component %u ", entityId, componentId);
             return;
         }
@@ -340,7 +774,7 @@ void EcstaticAddComponentToEntity(EcstaticWorld* world, EcstaticEntityId entityI
         return;
     }
 
-    memcpy(newComponentMask, oldArchetype->componentMask, oldArchetype->componentMaskCount * sizeof(uint64_t));
+    memcpy(newComponentMask, EcstaticGetArchetypeComponentMask(oldArchetype), oldArchetype->componentMaskCount * sizeof(uint64_t));
     newComponentMask[componentMaskIndex] |= 1ULL << (componentId % 64);
     
     EcstaticUpdateEntityComponents(world, entityId, newComponentMask, newComponentMaskCount);
@@ -353,15 +787,18 @@ void EcstaticRemoveComponentFromEntity(EcstaticWorld* world, EcstaticEntityId en
         return;
     }
 
+    if (world->componentIsShared[componentId]) {
+        EcstaticError(__func__, "Component %hu is shared", componentId);
+        return;
+    }
+
     uint32_t oldArchetypeId = EcstaticGetArchetypeIdFromEntityId(world, entityId);
     EcstaticArchetype* oldArchetype = &world->archetypes[oldArchetypeId];
     uint16_t componentMaskIndex = componentId / 64;
 
-    if (componentMaskIndex < oldArchetype->componentMaskCount) {
-        if (!(oldArchetype->componentMask[componentMaskIndex] & (1ULL << (componentId % 64)))) {
-            EcstaticError(__func__, "Entity %u does not have component %u ", entityId, componentId);
-            return;
-        }
+    if (componentMaskIndex >= oldArchetype->componentMaskCount || !(EcstaticGetArchetypeComponentMask(oldArchetype)[componentMaskIndex] & (1ULL << (componentId % 64)))) {
+        EcstaticError(__func__, "Entity %u does not have component %u ", entityId, componentId);
+        return;
     }
 
     uint64_t* newComponentMask = calloc(1, oldArchetype->componentMaskCount * sizeof(uint64_t));
@@ -370,7 +807,7 @@ void EcstaticRemoveComponentFromEntity(EcstaticWorld* world, EcstaticEntityId en
         return;
     }
 
-    memcpy(newComponentMask, oldArchetype->componentMask, oldArchetype->componentMaskCount * sizeof(uint64_t));
+    memcpy(newComponentMask, EcstaticGetArchetypeComponentMask(oldArchetype), oldArchetype->componentMaskCount * sizeof(uint64_t));
 
     newComponentMask[componentMaskIndex] &= ~(1ULL << (componentId % 64));
 
@@ -384,7 +821,7 @@ void EcstaticRemoveComponentFromEntity(EcstaticWorld* world, EcstaticEntityId en
 void* EcstaticGetEntityComponent(EcstaticWorld* world, EcstaticEntityId entityId, EcstaticComponentId componentId) {
     uint32_t archetypeId = EcstaticGetArchetypeIdFromEntityId(world, entityId);
     EcstaticArchetype* archetype = &world->archetypes[archetypeId];
-    uint16_t archetypeComponentId = EcstaticGetArchetypeComponentIdFromComponentId(archetype->componentMask, world->archetypes[archetypeId].componentMaskCount, componentId, false);
+    uint16_t archetypeComponentId = EcstaticGetArchetypeComponentIdFromComponentId(EcstaticGetArchetypeComponentMask(archetype), world->archetypes[archetypeId].componentMaskCount, componentId, false);
 
     if (archetypeComponentId == COMPONENT_INVALID) {
         return NULL;
@@ -401,6 +838,88 @@ void* EcstaticGetEntityComponent(EcstaticWorld* world, EcstaticEntityId entityId
     return (void*)(&archetypeComponent[archetypeEntityId * world->componentSizes[componentId]]);
 }
 
+void EcstaticSetEntitySharedComponent(EcstaticWorld* world, EcstaticEntityId entityId, EcstaticComponentId componentId, const void* value) {
+    uint32_t oldArchetypeId = EcstaticGetArchetypeIdFromEntityId(world, entityId);
+    if (oldArchetypeId == ARCHETYPE_INVALID) {
+        EcstaticError(__func__, "Invalid entity: %u ", entityId);
+        return;
+    }
+
+    EcstaticSharedValueId sharedValueId = EcstaticGetSharedValueId(world, componentId, value);
+    if (sharedValueId == SHARED_VALUE_INVALID) return;
+
+    EcstaticArchetype* oldArchetype = &world->archetypes[oldArchetypeId];
+    uint16_t oldSharedComponentCount = oldArchetype->sharedComponentCount;
+
+    uint16_t sharedComponentIndex = 0;
+    while (sharedComponentIndex < oldSharedComponentCount && world->sharedValueIdToComponentId[oldArchetype->sharedValueIds[sharedComponentIndex]] < componentId) sharedComponentIndex++;
+
+    bool hasComponent = sharedComponentIndex < oldSharedComponentCount && world->sharedValueIdToComponentId[oldArchetype->sharedValueIds[sharedComponentIndex]] == componentId;
+    if (hasComponent && oldArchetype->sharedValueIds[sharedComponentIndex] == sharedValueId) return;
+
+    uint16_t newSharedComponentCount = hasComponent ? oldSharedComponentCount : oldSharedComponentCount + 1;
+    uint32_t* newSharedValueIds = malloc(newSharedComponentCount * sizeof(uint32_t));
+    if (!newSharedValueIds) {
+        EcstaticError(__func__, "Failed to allocate %zu bytes for uint32_t* newSharedValueIds", newSharedComponentCount * sizeof(uint32_t));
+        return;
+    }
+
+    uint16_t tailIndex = hasComponent ? sharedComponentIndex + 1 : sharedComponentIndex;
+
+    memcpy(newSharedValueIds, oldArchetype->sharedValueIds, sharedComponentIndex * sizeof(uint32_t));
+    newSharedValueIds[sharedComponentIndex] = sharedValueId;
+    memcpy(newSharedValueIds + sharedComponentIndex + 1, oldArchetype->sharedValueIds + tailIndex, (oldSharedComponentCount - tailIndex) * sizeof(uint32_t));
+
+    EcstaticUpdateEntitySharedComponents(world, entityId, newSharedValueIds, newSharedComponentCount);
+    free(newSharedValueIds);
+}
+
+void EcstaticRemoveSharedComponentFromEntity(EcstaticWorld* world, EcstaticEntityId entityId, EcstaticComponentId componentId) {
+    if (componentId >= world->componentCount || !world->componentIsShared[componentId]) {
+        EcstaticError(__func__, "Invalid shared component: %hu", componentId);
+        return;
+    }
+
+    uint32_t oldArchetypeId = EcstaticGetArchetypeIdFromEntityId(world, entityId);
+    if (oldArchetypeId == ARCHETYPE_INVALID) {
+        EcstaticError(__func__, "Invalid entity: %u ", entityId);
+        return;
+    }
+
+    EcstaticArchetype* oldArchetype = &world->archetypes[oldArchetypeId];
+    uint16_t oldSharedComponentCount = oldArchetype->sharedComponentCount;
+
+    uint16_t sharedComponentIndex = 0;
+    while (sharedComponentIndex < oldSharedComponentCount && world->sharedValueIdToComponentId[oldArchetype->sharedValueIds[sharedComponentIndex]] != componentId) sharedComponentIndex++;
+
+    if (sharedComponentIndex == oldSharedComponentCount) {
+        EcstaticError(__func__, "Entity %u does not have component %u ", entityId, componentId);
+        return;
+    }
+
+    uint32_t* newSharedValueIds = malloc((oldSharedComponentCount == 1 ? 1 : oldSharedComponentCount - 1) * sizeof(uint32_t));
+    if (!newSharedValueIds) {
+        EcstaticError(__func__, "Failed to allocate %zu bytes for uint32_t* newSharedValueIds", (oldSharedComponentCount - 1) * sizeof(uint32_t));
+        return;
+    }
+
+    memcpy(newSharedValueIds, oldArchetype->sharedValueIds, sharedComponentIndex * sizeof(uint32_t));
+    memcpy(newSharedValueIds + sharedComponentIndex, oldArchetype->sharedValueIds + sharedComponentIndex + 1, (oldSharedComponentCount - sharedComponentIndex - 1) * sizeof(uint32_t));
+
+    EcstaticUpdateEntitySharedComponents(world, entityId, newSharedValueIds, oldSharedComponentCount - 1);
+    free(newSharedValueIds);
+}
+
+const void* EcstaticGetEntitySharedComponent(const EcstaticWorld* world, EcstaticEntityId entityId, EcstaticComponentId componentId) {
+    uint32_t archetypeId = EcstaticGetArchetypeIdFromEntityId(world, entityId);
+    if (archetypeId == ARCHETYPE_INVALID) {
+        EcstaticError(__func__, "Invalid entity: %u ", entityId);
+        return NULL;
+    }
+
+    return EcstaticGetArchetypeSharedComponent(world, archetypeId, componentId);
+}
+
 void EcstaticDestroyEntity(EcstaticWorld* world, EcstaticEntityId entityId) {
     if (entityId >= world->entityCapacity) {
         EcstaticError(__func__, "Invalid entity: %u ", entityId);
@@ -428,10 +947,10 @@ void EcstaticDestroyEntity(EcstaticWorld* world, EcstaticEntityId entityId) {
         world->entityIdToArchetypeEntityId[lastArchetypeEntityIdGlobal] = archetypeEntityId;
 
         for (uint32_t i = 0; i < archetype->componentCount; i++) {
-            uint32_t componentSize = world->componentSizes[EcstaticGetComponentIdFromArchetypeComponentId(archetype->componentMask, archetype->componentMaskCount, i)];
+            uint32_t componentSize = archetype->componentSizes[i];
             uint8_t* component = archetype->components[i];
 
-            memmove(component + (archetypeEntityId * componentSize), component + (lastArchetypeEntityId * componentSize), componentSize);
+            archetype->componentCopyFunctions[i](component + (archetypeEntityId * componentSize), component + (lastArchetypeEntityId * componentSize), componentSize);
         }
     }
 
@@ -442,7 +961,11 @@ void EcstaticDestroyEntity(EcstaticWorld* world, EcstaticEntityId entityId) {
     archetype->archetypeEntityIdToEntityId[lastArchetypeEntityId] = ENTITY_INVALID;
 }
 
-uint32_t EcstaticCreateArchetype(EcstaticWorld* world, uint64_t* componentMask, uint16_t componentMaskCount, uint32_t initialEntityCapacity) {
+uint32_t EcstaticCreateArchetype(EcstaticWorld* world, uint64_t* componentMask, uint16_t componentMaskCount, const uint32_t* sharedValueIds, uint16_t sharedComponentCount, uint32_t initialEntityCapacity) {
+    uint64_t inlineComponentMask[ECSTATIC_INLINE_COMPONENT_MASK_COUNT];
+    componentMaskCount = EcstaticNormalizeComponentMask(componentMask, componentMaskCount, inlineComponentMask);
+    if (componentMaskCount <= ECSTATIC_INLINE_COMPONENT_MASK_COUNT) componentMask = inlineComponentMask;
+
     world->archetypeCount++;
 
     void* tmp = realloc(world->archetypes, world->archetypeCount * sizeof(EcstaticArchetype));
@@ -456,23 +979,39 @@ uint32_t EcstaticCreateArchetype(EcstaticWorld* world, uint64_t* componentMask,
 
     EcstaticArchetype* archetype = &archetypes[world->archetypeCount - 1];
 
-    archetype->componentMask = calloc(1, (componentMaskCount == 0 ? 1 : componentMaskCount) * sizeof(uint64_t));
+    if (componentMaskCount <= ECSTATIC_INLINE_COMPONENT_MASK_COUNT) {
+        memcpy(archetype->inlineComponentMask, inlineComponentMask, sizeof(inlineComponentMask));
+        archetype->heapComponentMask = NULL;
+    } else {
+        memset(archetype->inlineComponentMask, 0, sizeof(archetype->inlineComponentMask));
 
-    if (componentMaskCount > 0) {
-        if (!archetype->componentMask) {
-            EcstaticError(__func__, "Failed to allocate %zu bytes for uint64_t* componentMask", componentMaskCount * sizeof(uint64_t));
+        archetype->heapComponentMask = malloc(componentMaskCount * sizeof(uint64_t));
+        if (!archetype->heapComponentMask) {
+            EcstaticError(__func__, "Failed to allocate %zu bytes for uint64_t* heapComponentMask", componentMaskCount * sizeof(uint64_t));
             return ARCHETYPE_INVALID;
         }
 
-        if (componentMask) memcpy(archetype->componentMask, componentMask, componentMaskCount * sizeof(uint64_t));
+        memcpy(archetype->heapComponentMask, componentMask, componentMaskCount * sizeof(uint64_t));
     }
 
     archetype->componentMaskCount = componentMaskCount;
 
+    archetype->sharedValueIds = malloc((sharedComponentCount == 0 ? 1 : sharedComponentCount) * sizeof(uint32_t));
+    if (!archetype->sharedValueIds) {
+        EcstaticError(__func__, "Failed to allocate %zu bytes for uint32_t* sharedValueIds", sharedComponentCount * sizeof(uint32_t));
+        free(archetype->heapComponentMask);
+        return ARCHETYPE_INVALID;
+    }
+
+    if (sharedComponentCount > 0) memcpy(archetype->sharedValueIds, sharedValueIds, sharedComponentCount * sizeof(uint32_t));
+
+    archetype->sharedComponentCount = sharedComponentCount;
+
     archetype->archetypeEntityIdToEntityId = malloc(initialEntityCapacity * sizeof(uint32_t));
     if (!archetype->archetypeEntityIdToEntityId) {
         EcstaticError(__func__, "Failed to allocate %zu bytes for uint32_t* archetypeEntityIdToEntityId", initialEntityCapacity * sizeof(uint32_t));
-        free(archetype->componentMask);
+        free(archetype->sharedValueIds);
+        free(archetype->heapComponentMask);
         return ARCHETYPE_INVALID;
     }
 
@@ -483,7 +1022,7 @@ uint32_t EcstaticCreateArchetype(EcstaticWorld* world, uint64_t* componentMask,
     uint32_t componentCount = 0;
 
     for (uint16_t i = 0; i < componentMaskCount; i++) {
-        componentCount += __builtin_popcountll(archetype->componentMask[i]);
+        componentCount += __builtin_popcountll(componentMask[i]);
     }
 
     archetype->componentCount = componentCount;
@@ -496,14 +1035,66 @@ uint32_t EcstaticCreateArchetype(EcstaticWorld* world, uint64_t* componentMask,
     if (!archetype->components) {
         EcstaticError(__func__, "Failed to allocate %zu bytes for void** components", componentCount * sizeof(void*));
         free(archetype->archetypeEntityIdToEntityId);
-        free(archetype->componentMask);
+        free(archetype->sharedValueIds);
+        free(archetype->heapComponentMask);
+        return ARCHETYPE_INVALID;
+    }
+
+    archetype->componentSizes = malloc((componentCount == 0 ? 1 : componentCount) * sizeof(uint32_t));
+    if (!archetype->componentSizes) {
+        EcstaticError(__func__, "Failed to allocate %zu bytes for uint32_t* componentSizes", componentCount * sizeof(uint32_t));
+        free(archetype->components);
+        free(archetype->archetypeEntityIdToEntityId);
+        free(archetype->sharedValueIds);
+        free(archetype->heapComponentMask);
+        return ARCHETYPE_INVALID;
+    }
+
+    archetype->componentCopyFunctions = malloc((componentCount == 0 ? 1 : componentCount) * sizeof(EcstaticComponentCopyFunction));
+    if (!archetype->componentCopyFunctions) {
+        EcstaticError(__func__, "Failed to allocate %zu bytes for EcstaticComponentCopyFunction* componentCopyFunctions", componentCount * sizeof(EcstaticComponentCopyFunction));
+        free(archetype->componentSizes);
+        free(archetype->components);
+        free(archetype->archetypeEntityIdToEntityId);
+        free(archetype->sharedValueIds);
+        free(archetype->heapComponentMask);
+        return ARCHETYPE_INVALID;
+    }
+
+    archetype->componentZeroFunctions = malloc((componentCount == 0 ? 1 : componentCount) * sizeof(EcstaticComponentZeroFunction));
+    if (!archetype->componentZeroFunctions) {
+        EcstaticError(__func__, "Failed to allocate %zu bytes for EcstaticComponentZeroFunction* componentZeroFunctions", componentCount * sizeof(EcstaticComponentZeroFunction));
+        free(archetype->componentCopyFunctions);
+        free(archetype->componentSizes);
+        free(archetype->components);
+        free(archetype->archetypeEntityIdToEntityId);
+        free(archetype->sharedValueIds);
+        free(archetype->heapComponentMask);
+        return ARCHETYPE_INVALID;
+    }
+
+    archetype->componentIds = malloc((componentCount == 0 ? 1 : componentCount) * sizeof(EcstaticComponentId));
+    if (!archetype->componentIds) {
+        EcstaticError(__func__, "Failed to allocate %zu bytes for EcstaticComponentId* componentIds", componentCount * sizeof(EcstaticComponentId));
+        free(archetype->componentZeroFunctions);
+        free(archetype->componentCopyFunctions);
+        free(archetype->componentSizes);
+        free(archetype->components);
+        free(archetype->archetypeEntityIdToEntityId);
+        free(archetype->sharedValueIds);
+        free(archetype->heapComponentMask);
         return ARCHETYPE_INVALID;
     }
 
     for (uint16_t i = 0; i < componentCount; i++) {
-        uint16_t globalComponentId = EcstaticGetComponentIdFromArchetypeComponentId(archetype->componentMask, componentMaskCount, i);
+        uint16_t globalComponentId = EcstaticGetComponentIdFromArchetypeComponentId(componentMask, componentMaskCount, i);
+
+        archetype->componentIds[i] = globalComponentId;
+        archetype->componentSizes[i] = world->componentSizes[globalComponentId];
+        archetype->componentCopyFunctions[i] = world->componentCopyFunctions[globalComponentId];
+        archetype->componentZeroFunctions[i] = world->componentZeroFunctions[globalComponentId];
 
-        uint32_t size = initialEntityCapacity * world->componentSizes[globalComponentId];
+        uint32_t size = initialEntityCapacity * archetype->componentSizes[i];
 
         archetype->components[i] = malloc(size);
         if (!archetype->components[i]) {
@@ -513,14 +1104,19 @@ uint32_t EcstaticCreateArchetype(EcstaticWorld* world, uint64_t* componentMask,
                 free(archetype->components[j]);
             }
 
+            free(archetype->componentIds);
+            free(archetype->componentZeroFunctions);
+            free(archetype->componentCopyFunctions);
+            free(archetype->componentSizes);
             free(archetype->components);
             free(archetype->archetypeEntityIdToEntityId);
-            free(archetype->componentMask);
+            free(archetype->sharedValueIds);
+            free(archetype->heapComponentMask);
             return ARCHETYPE_INVALID;
         }
     }
 
-    uint32_t hash = EcstaticGetArchetypeIdHashFromComponentMask(world, archetype->componentMask, componentMaskCount);
+    uint32_t hash = EcstaticGetArchetypeIdHashFromComponentMask(world, componentMask, componentMaskCount, archetype->sharedValueIds, sharedComponentCount);
 
     world->componentMaskToArchetypeBucketArchetypeCounts[hash]++;
 
@@ -531,9 +1127,14 @@ uint32_t EcstaticCreateArchetype(EcstaticWorld* world, uint64_t* componentMask,
             free(archetype->components[i]);
         }
 
+        free(archetype->componentIds);
+        free(archetype->componentZeroFunctions);
+        free(archetype->componentCopyFunctions);
+        free(archetype->componentSizes);
         free(archetype->components);
         free(archetype->archetypeEntityIdToEntityId);
-        free(archetype->componentMask);
+        free(archetype->sharedValueIds);
+        free(archetype->heapComponentMask);
         return ARCHETYPE_INVALID;
     }
     world->componentMaskToArchetypeBucketArchetypeIds[hash] = tmp2;
@@ -543,25 +1144,46 @@ uint32_t EcstaticCreateArchetype(EcstaticWorld* world, uint64_t* componentMask,
     return world->archetypeCount - 1;
 }
 
-uint32_t EcstaticGetArchetypeIdHashFromComponentMask(const EcstaticWorld* world, const uint64_t* componentMask, uint16_t componentMaskCount) {
-    return rapidhash(componentMask, componentMaskCount * sizeof(uint64_t)) % world->componentMaskToArchetypeBucketCount;
+uint32_t EcstaticGetArchetypeIdHashFromComponentMask(const EcstaticWorld* world, const uint64_t* componentMask, uint16_t componentMaskCount, const uint32_t* sharedValueIds, uint16_t sharedComponentCount) {
+    uint64_t hash = rapidhash(componentMask, componentMaskCount * sizeof(uint64_t));
+    if (sharedComponentCount > 0) hash = rapidhash_withSeed(sharedValueIds, sharedComponentCount * sizeof(uint32_t), hash);
+
+    return hash % world->componentMaskToArchetypeBucketCount;
 }
 
-uint32_t EcstaticGetArchetypeIdFromComponentMask(const EcstaticWorld* world, const uint64_t* componentMask, uint16_t componentMaskCount) {
-    uint32_t hash = EcstaticGetArchetypeIdHashFromComponentMask(world, componentMask, componentMaskCount);
+uint32_t EcstaticGetArchetypeIdFromComponentMask(const EcstaticWorld* world, const uint64_t* componentMask, uint16_t componentMaskCount, const uint32_t* sharedValueIds, uint16_t sharedComponentCount) {
+    uint64_t inlineComponentMask[ECSTATIC_INLINE_COMPONENT_MASK_COUNT];
+    componentMaskCount = EcstaticNormalizeComponentMask(componentMask, componentMaskCount, inlineComponentMask);
+    if (componentMaskCount <= ECSTATIC_INLINE_COMPONENT_MASK_COUNT) componentMask = inlineComponentMask;
+
+    uint32_t hash = EcstaticGetArchetypeIdHashFromComponentMask(world, componentMask, componentMaskCount, sharedValueIds, sharedComponentCount);
 
     uint32_t* hashBucketIds = world->componentMaskToArchetypeBucketArchetypeIds[hash];
     uint16_t hashBucketCounts = world->componentMaskToArchetypeBucketArchetypeCounts[hash];
 
     for (uint16_t i = 0; i < hashBucketCounts; i++) {
-        if (world->archetypes[hashBucketIds[i]].componentMaskCount != componentMaskCount) {
+        const EcstaticArchetype* iArchetype = &world->archetypes[hashBucketIds[i]];
+
+        if (iArchetype->componentMaskCount != componentMaskCount || iArchetype->sharedComponentCount != sharedComponentCount) {
             continue;
         }
 
-        uint64_t* iComponentMask = world->archetypes[hashBucketIds[i]].componentMask;
+        if (componentMaskCount <= ECSTATIC_INLINE_COMPONENT_MASK_COUNT) {
+            if (!EcstaticInlineComponentMaskEquals(iArchetype->inlineComponentMask, componentMask)) {
+                continue;
+            }
+        } else {
+            for (uint16_t j = 0; j < componentMaskCount; j++) {
+                if (iArchetype->heapComponentMask[j] != componentMask[j]) {
+                    goto continueOuter;
+                }
+            }
+        }
+
+        const uint32_t* iSharedValueIds = iArchetype->sharedValueIds;
 
-        for (uint16_t j = 0; j < componentMaskCount; j++) {
-            if (iComponentMask[j] != componentMask[j]) {
+        for (uint16_t j = 0; j < sharedComponentCount; j++) {
+            if (iSharedValueIds[j] != sharedValueIds[j]) {
                 goto continueOuter;
             }
         }
@@ -574,6 +1196,26 @@ uint32_t EcstaticGetArchetypeIdFromComponentMask(const EcstaticWorld* world, con
     return ARCHETYPE_INVALID;
 }
 
+const void* EcstaticGetArchetypeSharedComponent(const EcstaticWorld* world, EcstaticArchetypeId archetypeId, EcstaticComponentId componentId) {
+    if (archetypeId >= world->archetypeCount) {
+        EcstaticError(__func__, "Invalid archetype: %u ", archetypeId);
+        return NULL;
+    }
+
+    const EcstaticArchetype* archetype = &world->archetypes[archetypeId];
+
+    for (uint16_t i = 0; i < archetype->sharedComponentCount; i++) {
+        uint32_t sharedValueId = archetype->sharedValueIds[i];
+
+        if (world->sharedValueIdToComponentId[sharedValueId] == componentId) {
+            return world->sharedValues[sharedValueId];
+        }
+    }
+
+    EcstaticError(__func__, "Invalid component: %u ", componentId);
+    return NULL;
+}
+
 uint32_t EcstaticGetArchetypeIdFromEntityId(const EcstaticWorld* world, EcstaticEntityId entityId) {
     return entityId >= world->entityCapacity ? ARCHETYPE_INVALID : world->entityIdToArchetypeId[entityId];
 }
@@ -626,6 +1268,49 @@ uint16_t EcstaticGetArchetypeComponentIdFromComponentId(uint64_t* componentMask,
     return index + __builtin_popcountll(lowerBits);
 }
 
+uint64_t* EcstaticGetArchetypeComponentMask(EcstaticArchetype* archetype) {
+    return archetype->heapComponentMask ? archetype->heapComponentMask : archetype->inlineComponentMask;
+}
+
+uint16_t EcstaticNormalizeComponentMask(const uint64_t* componentMask, uint16_t componentMaskCount, uint64_t* inlineComponentMask) {
+    while (componentMaskCount > 0 && componentMask[componentMaskCount - 1] == 0ULL) componentMaskCount--;
+
+    if (componentMaskCount > ECSTATIC_INLINE_COMPONENT_MASK_COUNT) return componentMaskCount;
+
+    memset(inlineComponentMask, 0, ECSTATIC_INLINE_COMPONENT_MASK_COUNT * sizeof(uint64_t));
+    if (componentMaskCount > 0) memcpy(inlineComponentMask, componentMask, componentMaskCount * sizeof(uint64_t));
+
+    return componentMaskCount;
+}
+
+bool EcstaticInlineComponentMaskEquals(const uint64_t* a, const uint64_t* b) {
+#if defined(__AVX2__) && ECSTATIC_INLINE_COMPONENT_MASK_COUNT % 4 == 0
+    __m256i difference = _mm256_setzero_si256();
+
+    for (uint16_t i = 0; i < ECSTATIC_INLINE_COMPONENT_MASK_COUNT; i += 4) {
+        difference = _mm256_or_si256(difference, _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(a + i)), _mm256_loadu_si256((const __m256i*)(b + i))));
+    }
+
+    return _mm256_testz_si256(difference, difference);
+#elif defined(__SSE2__)
+    __m128i difference = _mm_setzero_si128();
+
+    for (uint16_t i = 0; i < ECSTATIC_INLINE_COMPONENT_MASK_COUNT; i += 2) {
+        difference = _mm_or_si128(difference, _mm_xor_si128(_mm_loadu_si128((const __m128i*)(a + i)), _mm_loadu_si128((const __m128i*)(b + i))));
+    }
+
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(difference, _mm_setzero_si128())) == 0xFFFF;
+#else
+    uint64_t difference = 0;
+
+    for (uint16_t i = 0; i < ECSTATIC_INLINE_COMPONENT_MASK_COUNT; i++) {
+        difference |= a[i] ^ b[i];
+    }
+
+    return difference == 0;
+#endif
+}
+
 uint8_t EcstaticGetNthSetBitIndex(uint64_t x, int n) {
     while (n--) x &= x - 1;
     return x ? __builtin_ctzll(x) : UINT8_MAX;